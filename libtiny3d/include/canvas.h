@@ -1,6 +1,8 @@
 #ifndef CANVAS_H
 #define CANVAS_H
 
+#include <stddef.h>
+
 typedef struct {
     int width;
     int height;
@@ -16,6 +18,9 @@ void canvas_destroy(canvas_t* canvas);
 // Save canvas as PGM image
 void canvas_save_pgm(canvas_t* canvas, const char* filename);
 
+// Encode canvas as a binary (P5) PGM in memory; caller frees the buffer
+unsigned char* canvas_encode_pgm(canvas_t* canvas, size_t* out_size);
+
 // Set a pixel using bilinear filtering (anti-aliased)
 void set_pixel_f(canvas_t* canvas, float x, float y, float intensity);
 
@@ -17,11 +17,18 @@ vec3_t vec3_from_spherical(float r, float theta, float phi);
 vec3_t vec3_normalize_fast(vec3_t v);
 vec3_t vec3_slerp(vec3_t a, vec3_t b, float t);
 
+// Batch variants built on fastmath.h (see there for error bounds).
+// Output arrays may alias the inputs.
+void vec3_from_spherical_batch(const float* r, const float* theta, const float* phi, vec3_t* out, int count);
+void vec3_normalize_fast_batch(const vec3_t* in, vec3_t* out, int count);
+void vec3_slerp_batch(const vec3_t* a, const vec3_t* b, const float* t, vec3_t* out, int count);
+
 // Matrix operations
 mat4_t mat4_identity();
 mat4_t mat4_translate(float tx, float ty, float tz);
 mat4_t mat4_scale(float sx, float sy, float sz);
 mat4_t mat4_rotate_xyz(float rx, float ry, float rz);
+void mat4_rotate_xyz_batch(const float* rx, const float* ry, const float* rz, mat4_t* out, int count);
 mat4_t mat4_frustum_asymmetric(float l, float r, float b, float t, float n, float f);
 vec3_t mat4_mul_vec3(mat4_t m, vec3_t v);
 mat4_t mat4_mul(mat4_t a, mat4_t b);
@@ -0,0 +1,27 @@
+#ifndef MESH_H
+#define MESH_H
+
+#include "math3d.h"
+
+typedef struct {
+    vec3_t* vertices;
+    int vertex_count;
+    int (*edges)[2];   // edge list built from the OBJ faces
+    int edge_count;
+    int* vertex_remap; // original index -> current index after mesh_optimize_order, else NULL
+} mesh_t;
+
+// Load .obj 'v' and 'f' lines into a heap-allocated mesh (NULL on failure)
+mesh_t* mesh_load_obj(const char* filename);
+
+// Reorder vertices along a Morton (Z-order) curve over their positions and
+// sort edges by their remapped endpoints, so consecutive edges touch nearby
+// vertices and nearby pixels. Edge directions are kept. The old-to-new vertex
+// mapping is stored in vertex_remap (composed with any earlier remap).
+// Returns 0 on allocation failure, leaving the mesh unchanged.
+int mesh_optimize_order(mesh_t* mesh);
+
+// Free mesh memory
+void mesh_destroy(mesh_t* mesh);
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef POINTS_H
+#define POINTS_H
+
+#include "math3d.h"
+#include "canvas.h"
+
+// Splat a point cloud onto the canvas. Each point is projected with the
+// MVP and spread over its 4 neighbouring pixels with bilinear weights, the
+// same way set_pixel_f does. Points behind the camera or off the canvas are
+// culled. The cloud is split across thread_count threads (<= 0 uses every
+// online CPU). The first thread accumulates straight into the canvas, the
+// others into private canvas-sized buffers, which are summed into the canvas
+// with SIMD and clamped to 1.0 at the end. Private buffers are capped at
+// 256 MiB per call, which limits the thread count on large canvases.
+// intensity >= 0.
+void render_points(canvas_t* canvas, const vec3_t* points, int point_count, mat4_t mvp, float intensity, int thread_count);
+
+#endif
@@ -0,0 +1,217 @@
+// render_client.c – load generator for render_server
+//
+// Opens several connections, sends batches of render requests for a
+// rotating mesh and reports batch latency percentiles and the share of
+// frames the server answered from its cache.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "math3d.h"
+#include "lighting.h"
+#include "render_protocol.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+typedef struct {
+    const char* socket_path;
+    int batches;
+    int batch_size;
+    int scenes;          // number of distinct rotation angles requested
+    int width, height;
+    unsigned seed;
+    double* latencies;   // one entry per batch, in milliseconds
+    long frames;
+    long cached;
+    long failed;
+} client_t;
+
+static int read_full(int fd, void* buf, size_t len) {
+    unsigned char* p = buf;
+    while (len > 0) {
+        ssize_t n = read(fd, p, len);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return 0;
+        p += n;
+        len -= n;
+    }
+    return 1;
+}
+
+static int write_full(int fd, const void* buf, size_t len) {
+    const unsigned char* p = buf;
+    while (len > 0) {
+        ssize_t n = send(fd, p, len, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return 0;
+        p += n;
+        len -= n;
+    }
+    return 1;
+}
+
+static double now_ms() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+static int connect_server(const char* path) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Same camera and lights as demo/main.c, one rotation step per scene
+static mat4_t scene_mvp(int scene, int scenes) {
+    float angle = (2 * M_PI * scene) / scenes;
+    mat4_t model = mat4_mul(mat4_translate(0, 0, -3.0f), mat4_rotate_xyz(angle, angle * 0.8f, 0));
+    mat4_t proj = mat4_frustum_asymmetric(-1, 1, -1, 1, 1.0f, 10.0f);
+    return mat4_mul(proj, model);
+}
+
+static void* client_main(void* arg) {
+    client_t* c = arg;
+    light_t lights[2] = {
+        {{ 0.0f, 0.0f, -1.0f }, 0.8f},
+        {{ 1.0f, 1.0f, -1.0f }, 0.5f}
+    };
+
+    int fd = connect_server(c->socket_path);
+    if (fd < 0) {
+        perror("connect");
+        c->failed = (long)c->batches * c->batch_size;
+        return NULL;
+    }
+
+    size_t max_frame = 64 + (size_t)c->width * c->height;
+    unsigned char* frame = malloc(max_frame);
+
+    for (int b = 0; b < c->batches && frame; b++) {
+        double start = now_ms();
+
+        render_batch_header_t header = { RENDER_MAGIC, (uint32_t)c->batch_size };
+        int ok = write_full(fd, &header, sizeof(header));
+        for (int i = 0; i < c->batch_size && ok; i++) {
+            mat4_t mvp = scene_mvp(rand_r(&c->seed) % c->scenes, c->scenes);
+            render_request_header_t req = { 0, (uint32_t)c->width, (uint32_t)c->height, 1, 2 };
+            ok = write_full(fd, &req, sizeof(req)) &&
+                 write_full(fd, &mvp, sizeof(mvp)) &&
+                 write_full(fd, lights, sizeof(lights));
+        }
+
+        for (int i = 0; i < c->batch_size && ok; i++) {
+            render_reply_header_t reply;
+            ok = read_full(fd, &reply, sizeof(reply)) && reply.size <= max_frame &&
+                 read_full(fd, frame, reply.size);
+            if (!ok) break;
+            c->frames++;
+            if (reply.status != RENDER_OK) c->failed++;
+            else if (reply.cached) c->cached++;
+        }
+        if (!ok) {
+            fprintf(stderr, "Connection lost\n");
+            c->failed += (long)(c->batches - b) * c->batch_size;
+            break;
+        }
+        c->latencies[b] = now_ms() - start;
+    }
+
+    free(frame);
+    close(fd);
+    return NULL;
+}
+
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile(const double* sorted, int n, double p) {
+    int i = (int)ceil(p / 100.0 * n) - 1;
+    if (i < 0) i = 0;
+    if (i >= n) i = n - 1;
+    return sorted[i];
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <socket_path> [connections=8] [batches=50] [batch_size=4] [scenes=32] [size=512]\n", argv[0]);
+        return 1;
+    }
+    int connections = argc > 2 ? atoi(argv[2]) : 8;
+    int batches = argc > 3 ? atoi(argv[3]) : 50;
+    int batch_size = argc > 4 ? atoi(argv[4]) : 4;
+    int scenes = argc > 5 ? atoi(argv[5]) : 32;
+    int size = argc > 6 ? atoi(argv[6]) : 512;
+    if (connections < 1 || batches < 1 || batch_size < 1 || batch_size > RENDER_MAX_BATCH ||
+        scenes < 1 || size < 1 || size > RENDER_MAX_SIZE) {
+        fprintf(stderr, "Invalid arguments\n");
+        return 1;
+    }
+
+    client_t* clients = calloc(connections, sizeof(client_t));
+    pthread_t* threads = calloc(connections, sizeof(pthread_t));
+    double* latencies = calloc((size_t)connections * batches, sizeof(double));
+    if (!clients || !threads || !latencies) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    double start = now_ms();
+    for (int i = 0; i < connections; i++) {
+        clients[i].socket_path = argv[1];
+        clients[i].batches = batches;
+        clients[i].batch_size = batch_size;
+        clients[i].scenes = scenes;
+        clients[i].width = clients[i].height = size;
+        clients[i].seed = 1234u + i;
+        clients[i].latencies = latencies + (size_t)i * batches;
+        pthread_create(&threads[i], NULL, client_main, &clients[i]);
+    }
+
+    long frames = 0, cached = 0, failed = 0;
+    for (int i = 0; i < connections; i++) {
+        pthread_join(threads[i], NULL);
+        frames += clients[i].frames;
+        cached += clients[i].cached;
+        failed += clients[i].failed;
+    }
+    double elapsed = now_ms() - start;
+
+    // Drop batches that never completed (latency left at 0)
+    int n = 0;
+    for (int i = 0; i < connections * batches; i++) {
+        if (latencies[i] > 0.0) latencies[n++] = latencies[i];
+    }
+    qsort(latencies, n, sizeof(double), compare_double);
+
+    printf("frames: %ld (%ld cached, %ld failed) in %.1f ms, %.1f frames/s\n",
+           frames, cached, failed, elapsed, frames * 1000.0 / elapsed);
+    if (n > 0) {
+        printf("batch latency: p50 %.2f ms, p99 %.2f ms, max %.2f ms\n",
+               percentile(latencies, n, 50), percentile(latencies, n, 99), latencies[n - 1]);
+    }
+
+    free(clients);
+    free(threads);
+    free(latencies);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,48 @@
+#ifndef RENDER_PROTOCOL_H
+#define RENDER_PROTOCOL_H
+
+#include <stdint.h>
+#include "math3d.h"
+#include "lighting.h"
+
+// Wire format for the local render server. Both ends live on the same host
+// (Unix domain socket), so structs are sent in native byte order.
+//
+// client -> server: render_batch_header_t, then request_count times
+//                   { render_request_header_t, mat4_t[mvp_count], light_t[light_count] }
+// server -> client: request_count times
+//                   { render_reply_header_t, size bytes of binary PGM (P5) }
+// Replies come back in the same order as the requests of the batch.
+
+#define RENDER_MAGIC      0x54334452u // "RD3T"
+#define RENDER_MAX_BATCH  64
+#define RENDER_MAX_MVPS   16
+#define RENDER_MAX_SIZE   4096
+
+enum {
+    RENDER_OK = 0,
+    RENDER_BAD_REQUEST = 1,
+    RENDER_NO_MESH = 2,
+    RENDER_FAILED = 3
+};
+
+typedef struct {
+    uint32_t magic;
+    uint32_t request_count;
+} render_batch_header_t;
+
+typedef struct {
+    uint32_t mesh_id;      // index of the mesh in the server's command line
+    uint32_t width;
+    uint32_t height;
+    uint32_t mvp_count;    // each MVP draws the mesh once onto the same canvas
+    uint32_t light_count;
+} render_request_header_t;
+
+typedef struct {
+    uint32_t status;
+    uint32_t cached;       // 1 if served from the frame cache or an in-flight render
+    uint32_t size;
+} render_reply_header_t;
+
+#endif
@@ -0,0 +1,411 @@
+// render_server.c – long-lived render daemon over a Unix domain socket
+//
+// Meshes are loaded once at startup and stay resident. Each connection
+// thread reads a batch of requests, looks every request up in an LRU cache
+// of encoded frames keyed by a scene hash, and queues misses for a shared
+// pool of render workers. A request whose scene is already being rendered
+// waits for that render instead of queueing a duplicate.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include "canvas.h"
+#include "math3d.h"
+#include "lighting.h"
+#include "renderer.h"
+#include "mesh.h"
+#include "render_protocol.h"
+
+#define DEFAULT_CACHE_SIZE 64
+
+// Everything that determines the rendered image
+typedef struct {
+    render_request_header_t req;
+    mat4_t mvps[RENDER_MAX_MVPS];
+    light_t lights[MAX_LIGHTS];
+} scene_t;
+
+// Encoded frame shared by the cache, the worker rendering it and every
+// request waiting on it. Freed when the last reference is released.
+typedef struct {
+    uint64_t hash;
+    scene_t scene;     // compared on hash match so collisions can't mix up frames
+    int refs;
+    int ready;
+    uint32_t status;
+    size_t size;
+    unsigned char* data;
+} frame_t;
+
+typedef struct {
+    frame_t* frame;
+    unsigned long last_used;
+} cache_slot_t;
+
+typedef struct job {
+    frame_t* frame;
+    scene_t scene;
+    struct job* next;
+} job_t;
+
+static mesh_t** meshes;
+static int mesh_count;
+
+// One lock guards the cache, frame state and the job queue; the critical
+// sections are tiny next to a render.
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t frame_done = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t job_ready = PTHREAD_COND_INITIALIZER;
+
+static cache_slot_t* cache;
+static int cache_size = DEFAULT_CACHE_SIZE;
+static unsigned long cache_clock;
+
+static job_t* queue_head;
+static job_t* queue_tail;
+
+static int read_full(int fd, void* buf, size_t len) {
+    unsigned char* p = buf;
+    while (len > 0) {
+        ssize_t n = read(fd, p, len);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return 0;
+        p += n;
+        len -= n;
+    }
+    return 1;
+}
+
+static int write_full(int fd, const void* buf, size_t len) {
+    const unsigned char* p = buf;
+    while (len > 0) {
+        ssize_t n = send(fd, p, len, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return 0;
+        p += n;
+        len -= n;
+    }
+    return 1;
+}
+
+// FNV-1a over the bytes that determine the rendered image
+static uint64_t hash_bytes(uint64_t h, const void* data, size_t len) {
+    const unsigned char* p = data;
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+static uint64_t scene_hash(const scene_t* sc) {
+    uint64_t h = 14695981039346656037ull;
+    h = hash_bytes(h, &sc->req, sizeof(sc->req));
+    h = hash_bytes(h, sc->mvps, sizeof(mat4_t) * sc->req.mvp_count);
+    h = hash_bytes(h, sc->lights, sizeof(light_t) * sc->req.light_count);
+    return h;
+}
+
+// Compares the same bytes scene_hash covers
+static int scene_equal(const scene_t* a, const scene_t* b) {
+    return memcmp(&a->req, &b->req, sizeof(a->req)) == 0 &&
+           memcmp(a->mvps, b->mvps, sizeof(mat4_t) * a->req.mvp_count) == 0 &&
+           memcmp(a->lights, b->lights, sizeof(light_t) * a->req.light_count) == 0;
+}
+
+// Caller holds lock
+static void frame_release(frame_t* f) {
+    if (--f->refs == 0) {
+        free(f->data);
+        free(f);
+    }
+}
+
+// Caller holds lock. Returns a referenced frame; *created is set when the
+// caller must queue a render for it.
+static frame_t* cache_acquire(const scene_t* scene, uint64_t hash, int* created) {
+    int victim = 0;
+    for (int i = 0; i < cache_size; i++) {
+        frame_t* f = cache[i].frame;
+        if (f && f->hash == hash && scene_equal(&f->scene, scene)) {
+            cache[i].last_used = ++cache_clock;
+            f->refs++;
+            *created = 0;
+            return f;
+        }
+        if (!f || (cache[victim].frame && cache[i].last_used < cache[victim].last_used))
+            victim = i;
+    }
+
+    frame_t* f = calloc(1, sizeof(frame_t));
+    if (!f) return NULL;
+    f->hash = hash;
+    f->scene = *scene;
+    f->refs = 2; // cache + caller
+    if (cache[victim].frame) frame_release(cache[victim].frame);
+    cache[victim].frame = f;
+    cache[victim].last_used = ++cache_clock;
+    *created = 1;
+    return f;
+}
+
+// Caller holds lock. Failed renders must not be served to later requests.
+static void cache_drop(frame_t* f) {
+    for (int i = 0; i < cache_size; i++) {
+        if (cache[i].frame == f) {
+            cache[i].frame = NULL;
+            cache[i].last_used = 0;
+            frame_release(f);
+            return;
+        }
+    }
+}
+
+static void render_job(job_t* job) {
+    const mesh_t* mesh = meshes[job->scene.req.mesh_id];
+    canvas_t* canvas = canvas_create(job->scene.req.width, job->scene.req.height);
+    unsigned char* data = NULL;
+    size_t size = 0;
+
+    if (canvas && canvas->pixels) {
+        for (uint32_t i = 0; i < job->scene.req.mvp_count; i++) {
+            render_wireframe(canvas, mesh->vertices, mesh->vertex_count, mesh->edges, mesh->edge_count,
+                             job->scene.mvps[i], job->scene.lights, job->scene.req.light_count);
+        }
+        data = canvas_encode_pgm(canvas, &size);
+    }
+    canvas_destroy(canvas);
+
+    pthread_mutex_lock(&lock);
+    job->frame->data = data;
+    job->frame->size = size;
+    job->frame->status = data ? RENDER_OK : RENDER_FAILED;
+    job->frame->ready = 1;
+    if (!data) cache_drop(job->frame);
+    frame_release(job->frame);
+    pthread_cond_broadcast(&frame_done);
+    pthread_mutex_unlock(&lock);
+}
+
+static void* worker_main(void* arg) {
+    (void)arg;
+    for (;;) {
+        pthread_mutex_lock(&lock);
+        while (!queue_head)
+            pthread_cond_wait(&job_ready, &lock);
+        job_t* job = queue_head;
+        queue_head = job->next;
+        if (!queue_head) queue_tail = NULL;
+        pthread_mutex_unlock(&lock);
+
+        render_job(job);
+        free(job);
+    }
+    return NULL;
+}
+
+// Read one request; returns 0 if the connection is unusable, otherwise
+// fills *status with the validation result.
+static int read_request(int fd, job_t* job, uint32_t* status) {
+    if (!read_full(fd, &job->scene.req, sizeof(job->scene.req))) return 0;
+
+    const render_request_header_t* r = &job->scene.req;
+    if (r->mvp_count > RENDER_MAX_MVPS || r->light_count > MAX_LIGHTS)
+        return 0; // payload length is untrustworthy, drop the connection
+
+    if (!read_full(fd, job->scene.mvps, sizeof(mat4_t) * r->mvp_count)) return 0;
+    if (!read_full(fd, job->scene.lights, sizeof(light_t) * r->light_count)) return 0;
+
+    if (r->width == 0 || r->height == 0 || r->width > RENDER_MAX_SIZE || r->height > RENDER_MAX_SIZE)
+        *status = RENDER_BAD_REQUEST;
+    else if (r->mesh_id >= (uint32_t)mesh_count)
+        *status = RENDER_NO_MESH;
+    else
+        *status = RENDER_OK;
+    return 1;
+}
+
+static int serve_batch(int fd) {
+    render_batch_header_t header;
+    if (!read_full(fd, &header, sizeof(header))) return 0;
+    if (header.magic != RENDER_MAGIC || header.request_count > RENDER_MAX_BATCH) return 0;
+
+    uint32_t count = header.request_count;
+    frame_t* frames[RENDER_MAX_BATCH] = {0};
+    uint32_t status[RENDER_MAX_BATCH];
+    uint32_t cached[RENDER_MAX_BATCH] = {0};
+    int ok = 1;
+
+    for (uint32_t i = 0; i < count && ok; i++) {
+        job_t* job = malloc(sizeof(job_t));
+        if (!job || !read_request(fd, job, &status[i])) {
+            free(job);
+            ok = 0;
+            break;
+        }
+        if (status[i] != RENDER_OK) {
+            free(job);
+            continue;
+        }
+
+        uint64_t hash = scene_hash(&job->scene);
+        int created = 0;
+        pthread_mutex_lock(&lock);
+        frames[i] = cache_acquire(&job->scene, hash, &created);
+        if (frames[i] && created) {
+            frames[i]->refs++; // held by the job until the worker finishes
+            job->frame = frames[i];
+            job->next = NULL;
+            if (queue_tail) queue_tail->next = job;
+            else queue_head = job;
+            queue_tail = job;
+            pthread_cond_signal(&job_ready);
+            job = NULL;
+        }
+        pthread_mutex_unlock(&lock);
+
+        if (!frames[i]) status[i] = RENDER_FAILED;
+        else if (!created) cached[i] = 1;
+        free(job);
+    }
+
+    // Wait for every frame of the batch, then reply in request order
+    pthread_mutex_lock(&lock);
+    for (uint32_t i = 0; i < count; i++) {
+        while (frames[i] && !frames[i]->ready)
+            pthread_cond_wait(&frame_done, &lock);
+    }
+    pthread_mutex_unlock(&lock);
+
+    for (uint32_t i = 0; i < count && ok; i++) {
+        render_reply_header_t reply = { status[i], cached[i], 0 };
+        if (frames[i]) {
+            reply.status = frames[i]->status;
+            reply.size = (uint32_t)frames[i]->size;
+        }
+        if (!write_full(fd, &reply, sizeof(reply))) ok = 0;
+        else if (reply.size && !write_full(fd, frames[i]->data, reply.size)) ok = 0;
+    }
+
+    pthread_mutex_lock(&lock);
+    for (uint32_t i = 0; i < count; i++) {
+        if (frames[i]) frame_release(frames[i]);
+    }
+    pthread_mutex_unlock(&lock);
+    return ok;
+}
+
+static void* connection_main(void* arg) {
+    int fd = (int)(intptr_t)arg;
+    while (serve_batch(fd)) {
+    }
+    close(fd);
+    return NULL;
+}
+
+static void usage(const char* prog) {
+    fprintf(stderr, "usage: %s [-w workers] [-c cache_frames] <socket_path> <mesh.obj> [mesh.obj ...]\n", prog);
+}
+
+int main(int argc, char** argv) {
+    long workers = sysconf(_SC_NPROCESSORS_ONLN);
+    int opt;
+    while ((opt = getopt(argc, argv, "w:c:")) != -1) {
+        if (opt == 'w') workers = atol(optarg);
+        else if (opt == 'c') cache_size = atoi(optarg);
+        else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (argc - optind < 2 || workers < 1 || cache_size < 1) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    const char* socket_path = argv[optind];
+    mesh_count = argc - optind - 1;
+    meshes = calloc(mesh_count, sizeof(mesh_t*));
+    cache = calloc(cache_size, sizeof(cache_slot_t));
+    if (!meshes || !cache) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    for (int i = 0; i < mesh_count; i++) {
+        meshes[i] = mesh_load_obj(argv[optind + 1 + i]);
+        if (!meshes[i]) {
+            fprintf(stderr, "Failed to load %s\n", argv[optind + 1 + i]);
+            return 1;
+        }
+        // Meshes stay resident, so the reordering pass pays for itself quickly
+        if (!mesh_optimize_order(meshes[i]))
+            fprintf(stderr, "Could not reorder %s, rendering it as loaded\n", argv[optind + 1 + i]);
+        printf("mesh %d: %s (%d vertices, %d edges)\n", i, argv[optind + 1 + i],
+               meshes[i]->vertex_count, meshes[i]->edge_count);
+    }
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(socket_path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "Socket path too long\n");
+        return 1;
+    }
+    strcpy(addr.sun_path, socket_path);
+
+    int server_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server_fd < 0) {
+        perror("socket");
+        return 1;
+    }
+    // Only replace a stale socket; never delete a regular file given by mistake
+    struct stat st;
+    if (lstat(socket_path, &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) {
+            fprintf(stderr, "%s exists and is not a socket, refusing to replace it\n", socket_path);
+            return 1;
+        }
+        unlink(socket_path);
+    }
+    if (bind(server_fd, (struct sockaddr*)&addr, sizeof(addr)) < 0 || listen(server_fd, 64) < 0) {
+        perror("bind/listen");
+        return 1;
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+    for (long i = 0; i < workers; i++) {
+        pthread_t t;
+        if (pthread_create(&t, NULL, worker_main, NULL) != 0) {
+            fprintf(stderr, "Failed to start worker\n");
+            return 1;
+        }
+        pthread_detach(t);
+    }
+    printf("Listening on %s with %ld workers, %d cached frames\n", socket_path, workers, cache_size);
+    fflush(stdout);
+
+    for (;;) {
+        int fd = accept(server_fd, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            perror("accept");
+            break;
+        }
+        pthread_t t;
+        if (pthread_create(&t, NULL, connection_main, (void*)(intptr_t)fd) != 0) {
+            close(fd);
+            continue;
+        }
+        pthread_detach(t);
+    }
+
+    close(server_fd);
+    unlink(socket_path);
+    return 0;
+}
@@ -1,5 +1,6 @@
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
 #include "canvas.h"
 
@@ -35,6 +36,25 @@ void canvas_save_pgm(canvas_t* c, const char* filename) {
     fclose(f);
 }
 
+unsigned char* canvas_encode_pgm(canvas_t* c, size_t* out_size) {
+    char header[32];
+    int header_len = snprintf(header, sizeof(header), "P5\n%d %d\n255\n", c->width, c->height);
+    size_t pixel_count = (size_t)c->width * c->height;
+    unsigned char* buf = malloc(header_len + pixel_count);
+    if (!buf) return NULL;
+
+    memcpy(buf, header, header_len);
+    unsigned char* out = buf + header_len;
+    for (size_t i = 0; i < pixel_count; i++) {
+        float intensity = c->pixels[i];
+        if (intensity < 0.0f) intensity = 0.0f;
+        if (intensity > 1.0f) intensity = 1.0f;
+        out[i] = (unsigned char)(intensity * 255);
+    }
+    *out_size = header_len + pixel_count;
+    return buf;
+}
+
 // Set pixel using bilinear filtering (splits brightness to 4 nearby pixels)
 void set_pixel_f(canvas_t* c, float x, float y, float intensity) {
     int x0 = (int)floorf(x);
@@ -0,0 +1,191 @@
+#include <math.h>
+#include "fastmath.h"
+
+#define FM_2_OVER_PI 0.63661977236758134f
+#define FM_PI        3.14159265358979323846f
+
+// pi/2 split into three parts so j * PIO2_1 is exact for |j| < 2^16
+#define PIO2_1 1.5703125f
+#define PIO2_2 4.8375129699707031e-4f
+#define PIO2_3 7.5497899548918821e-8f
+
+// Minimax coefficients on [-pi/4, pi/4] (Cephes sinf/cosf)
+#define SIN_C1 -1.6666654611e-1f
+#define SIN_C2  8.3321608736e-3f
+#define SIN_C3 -1.9515295891e-4f
+#define COS_C1  4.166664568298827e-2f
+#define COS_C2 -1.388731625493765e-3f
+#define COS_C3  2.443315711809948e-5f
+
+// acos(x) ~= sqrt(1 - x) * P(x) on [0, 1] (Abramowitz & Stegun 4.4.46)
+#define ACOS_A0  1.5707963050f
+#define ACOS_A1 -0.2145988016f
+#define ACOS_A2  0.0889789874f
+#define ACOS_A3 -0.0501743046f
+#define ACOS_A4  0.0308918810f
+#define ACOS_A5 -0.0170881256f
+#define ACOS_A6  0.0066700901f
+#define ACOS_A7 -0.0012624911f
+
+// Sine and cosine sharing one range reduction
+void fm_sincos(float x, float* s, float* c) {
+    if (!(fabsf(x) <= FM_SINCOS_MAX)) { // also catches NaN
+        *s = sinf(x);
+        *c = cosf(x);
+        return;
+    }
+    float fj = x * FM_2_OVER_PI;
+    int j = (int)(fj < 0.0f ? fj - 0.5f : fj + 0.5f);
+    float jf = (float)j;
+    float r = ((x - jf * PIO2_1) - jf * PIO2_2) - jf * PIO2_3;
+    float z = r * r;
+
+    float sp = r + r * z * (SIN_C1 + z * (SIN_C2 + z * SIN_C3));
+    float cp = 1.0f - 0.5f * z + z * z * (COS_C1 + z * (COS_C2 + z * COS_C3));
+
+    // Quadrant j & 3 selects which polynomial feeds sin/cos and their signs
+    float sv = (j & 1) ? cp : sp;
+    float cv = (j & 1) ? sp : cp;
+    *s = (j & 2) ? -sv : sv;
+    *c = ((j + 1) & 2) ? -cv : cv;
+}
+
+float fm_rsqrt_exact(float x) {
+    return x > 0.0f || x != x ? 1.0f / sqrtf(x) : 0.0f;
+}
+
+static float sqrt_approx(float x) {
+    return x * fm_rsqrt(x);
+}
+
+float fm_acos(float x) {
+    if (x > 1.0f) x = 1.0f;
+    if (x < -1.0f) x = -1.0f;
+    float a = x < 0.0f ? -x : x;
+    float p = ACOS_A0 + a * (ACOS_A1 + a * (ACOS_A2 + a * (ACOS_A3 +
+              a * (ACOS_A4 + a * (ACOS_A5 + a * (ACOS_A6 + a * ACOS_A7))))));
+    float r = sqrt_approx(1.0f - a) * p;
+    return x < 0.0f ? FM_PI - r : r;
+}
+
+#if defined(__SSE2__)
+
+// Same results as the scalar fm_rsqrt: normal lanes use the estimate plus
+// one Newton step, subnormal, infinite and NaN lanes get the exact
+// 1 / sqrt, and lanes with x <= 0 return 0
+static __m128 rsqrt4(__m128 x) {
+    __m128 y = _mm_rsqrt_ps(x);
+    __m128 hx = _mm_mul_ps(_mm_set1_ps(0.5f), x);
+    y = _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(hx, _mm_mul_ps(y, y))));
+    __m128 normal = _mm_and_ps(_mm_cmpge_ps(x, _mm_set1_ps(FLT_MIN)),
+                               _mm_cmple_ps(x, _mm_set1_ps(FLT_MAX)));
+    if (_mm_movemask_ps(normal) == 0xF) return y;
+
+    // Unordered compare keeps NaN lanes, x <= 0 is masked to 0
+    __m128 exact = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(x));
+    exact = _mm_and_ps(_mm_cmpnle_ps(x, _mm_setzero_ps()), exact);
+    return _mm_or_ps(_mm_and_ps(normal, y), _mm_andnot_ps(normal, exact));
+}
+
+static void sincos4(__m128 x, __m128* s, __m128* c) {
+    __m128i j = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(FM_2_OVER_PI)));
+    __m128 jf = _mm_cvtepi32_ps(j);
+    __m128 r = _mm_sub_ps(x, _mm_mul_ps(jf, _mm_set1_ps(PIO2_1)));
+    r = _mm_sub_ps(r, _mm_mul_ps(jf, _mm_set1_ps(PIO2_2)));
+    r = _mm_sub_ps(r, _mm_mul_ps(jf, _mm_set1_ps(PIO2_3)));
+    __m128 z = _mm_mul_ps(r, r);
+
+    __m128 sp = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(SIN_C3), z), _mm_set1_ps(SIN_C2));
+    sp = _mm_add_ps(_mm_mul_ps(sp, z), _mm_set1_ps(SIN_C1));
+    sp = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, z), sp));
+
+    __m128 cp = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(COS_C3), z), _mm_set1_ps(COS_C2));
+    cp = _mm_add_ps(_mm_mul_ps(cp, z), _mm_set1_ps(COS_C1));
+    cp = _mm_mul_ps(_mm_mul_ps(z, z), cp);
+    cp = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_set1_ps(0.5f), z)), cp);
+
+    __m128i one = _mm_set1_epi32(1);
+    __m128i two = _mm_set1_epi32(2);
+    __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, one), one));
+    __m128 sv = _mm_or_ps(_mm_and_ps(swap, cp), _mm_andnot_ps(swap, sp));
+    __m128 cv = _mm_or_ps(_mm_and_ps(swap, sp), _mm_andnot_ps(swap, cp));
+
+    // Move quadrant bit 1 into the float sign bit
+    __m128 s_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, two), 30));
+    __m128 c_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(j, one), two), 30));
+    *s = _mm_xor_ps(sv, s_sign);
+    *c = _mm_xor_ps(cv, c_sign);
+}
+
+static __m128 acos4(__m128 x) {
+    // max/min return their second operand when either is NaN, so x goes
+    // second and NaN lanes stay NaN like the scalar fm_acos
+    x = _mm_min_ps(_mm_set1_ps(1.0f), _mm_max_ps(_mm_set1_ps(-1.0f), x));
+    __m128 a = _mm_andnot_ps(_mm_set1_ps(-0.0f), x);
+
+    __m128 p = _mm_set1_ps(ACOS_A7);
+    p = _mm_add_ps(_mm_mul_ps(p, a), _mm_set1_ps(ACOS_A6));
+    p = _mm_add_ps(_mm_mul_ps(p, a), _mm_set1_ps(ACOS_A5));
+    p = _mm_add_ps(_mm_mul_ps(p, a), _mm_set1_ps(ACOS_A4));
+    p = _mm_add_ps(_mm_mul_ps(p, a), _mm_set1_ps(ACOS_A3));
+    p = _mm_add_ps(_mm_mul_ps(p, a), _mm_set1_ps(ACOS_A2));
+    p = _mm_add_ps(_mm_mul_ps(p, a), _mm_set1_ps(ACOS_A1));
+    p = _mm_add_ps(_mm_mul_ps(p, a), _mm_set1_ps(ACOS_A0));
+
+    // sqrt(1 - a) as (1 - a) * rsqrt(1 - a); rsqrt4 already gives 0 at a == 1
+    __m128 u = _mm_sub_ps(_mm_set1_ps(1.0f), a);
+    __m128 root = _mm_mul_ps(u, rsqrt4(u));
+    __m128 r = _mm_mul_ps(root, p);
+
+    __m128 neg = _mm_cmplt_ps(x, _mm_setzero_ps());
+    __m128 flipped = _mm_sub_ps(_mm_set1_ps(FM_PI), r);
+    return _mm_or_ps(_mm_and_ps(neg, flipped), _mm_andnot_ps(neg, r));
+}
+
+#endif
+
+void fm_sincos_batch(const float* x, float* s, float* c, int count) {
+    int i = 0;
+#if defined(__SSE2__)
+    for (; i + 4 <= count; i += 4) {
+        __m128 xv = _mm_loadu_ps(x + i);
+        __m128 sv, cv;
+        sincos4(xv, &sv, &cv);
+        // Unordered compare, so NaN lanes count as out of range too
+        __m128 abs_x = _mm_andnot_ps(_mm_set1_ps(-0.0f), xv);
+        int outside = _mm_movemask_ps(_mm_cmpnle_ps(abs_x, _mm_set1_ps(FM_SINCOS_MAX)));
+        float xs[4];
+        _mm_storeu_ps(xs, xv);
+        _mm_storeu_ps(s + i, sv);
+        _mm_storeu_ps(c + i, cv);
+        for (int k = 0; outside && k < 4; k++) {
+            if (outside & (1 << k)) {
+                s[i + k] = sinf(xs[k]);
+                c[i + k] = cosf(xs[k]);
+            }
+        }
+    }
+#endif
+    for (; i < count; i++)
+        fm_sincos(x[i], &s[i], &c[i]);
+}
+
+void fm_acos_batch(const float* x, float* out, int count) {
+    int i = 0;
+#if defined(__SSE2__)
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(out + i, acos4(_mm_loadu_ps(x + i)));
+#endif
+    for (; i < count; i++)
+        out[i] = fm_acos(x[i]);
+}
+
+void fm_rsqrt_batch(const float* x, float* out, int count) {
+    int i = 0;
+#if defined(__SSE2__)
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(out + i, rsqrt4(_mm_loadu_ps(x + i)));
+#endif
+    for (; i < count; i++)
+        out[i] = fm_rsqrt(x[i]);
+}
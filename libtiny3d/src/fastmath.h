@@ -0,0 +1,61 @@
+#ifndef FASTMATH_H
+#define FASTMATH_H
+
+#include <math.h>
+#include <float.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Domain of the polynomial sincos; range reduction loses bits beyond it
+#define FM_SINCOS_MAX 8192.0f
+
+// Internal to the library (not installed with include/): polynomial
+// approximations used by the batch functions in math3d.h.
+// Batch functions run 4 lanes at a time with SSE2 when available and fall
+// back to the same polynomials in scalar code. Output arrays may alias the
+// inputs. Error bounds (measured against double-precision libm, see
+// tests/test_fastmath.c):
+//
+//   fm_sincos   absolute error <= 3e-7 for |x| <= FM_SINCOS_MAX; larger,
+//               infinite or NaN inputs are handed to sinf/cosf instead
+//   fm_acos     absolute error <= 1e-6 on [-1, 1]; inputs are clamped and
+//               NaN returns NaN in every path
+//   fm_rsqrt    relative error <= 1e-6 for FLT_MIN <= x <= FLT_MAX;
+//               subnormal and infinite x get the exact 1 / sqrtf, NaN stays
+//               NaN, and x <= 0 returns 0 in every path, so zero-length
+//               vectors normalize to zero
+//
+// fm_rsqrt is inline because it sits on per-edge hot paths: hardware
+// estimate plus one Newton-Raphson step with SSE2, plain 1 / sqrtf otherwise.
+// The estimate treats subnormals as zero and returns 0 for +inf, which the
+// Newton step would turn into NaN, so those inputs take the exact path.
+
+void fm_sincos(float x, float* s, float* c);
+float fm_acos(float x);
+
+// Exact 1 / sqrtf with the same 0 for x <= 0; out of line so the inline
+// fast path stays small enough to unroll
+float fm_rsqrt_exact(float x);
+
+static inline float fm_rsqrt(float x) {
+#if defined(__SSE2__)
+    if (x >= FLT_MIN && x <= FLT_MAX) {
+        // set1 avoids the GPR round trip _mm_set_ss costs; the Newton step
+        // is regrouped so hx * y and y * y issue in parallel
+        float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set1_ps(x)));
+        float hx = 0.5f * x;
+        return 1.5f * y - (hx * y) * (y * y);
+    }
+    return fm_rsqrt_exact(x);
+#else
+    return x > 0.0f || x != x ? 1.0f / sqrtf(x) : 0.0f;
+#endif
+}
+
+void fm_sincos_batch(const float* x, float* s, float* c, int count);
+void fm_acos_batch(const float* x, float* out, int count);
+void fm_rsqrt_batch(const float* x, float* out, int count);
+
+#endif
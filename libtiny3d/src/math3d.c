@@ -1,5 +1,9 @@
 #include <math.h>
 #include "math3d.h"
+#include "fastmath.h"
+
+// Batch functions work through their input in chunks of this many elements
+#define BATCH_CHUNK 64
 
 // Convert spherical to Cartesian
 vec3_t vec3_from_spherical(float r, float theta, float phi) {
@@ -13,7 +17,7 @@ vec3_t vec3_from_spherical(float r, float theta, float phi) {
 // Normalize vector using fast inverse square root
 vec3_t vec3_normalize_fast(vec3_t v) {
     float len_sq = v.x*v.x + v.y*v.y + v.z*v.z;
-    float inv_len = 1.0f / sqrtf(len_sq);
+    float inv_len = fm_rsqrt(len_sq);
     v.x *= inv_len;
     v.y *= inv_len;
     v.z *= inv_len;
@@ -38,6 +42,75 @@ vec3_t vec3_slerp(vec3_t a, vec3_t b, float t) {
     return result;
 }
 
+void vec3_from_spherical_batch(const float* r, const float* theta, const float* phi, vec3_t* out, int count) {
+    float st[BATCH_CHUNK], ct[BATCH_CHUNK];
+    float sp[BATCH_CHUNK], cp[BATCH_CHUNK];
+
+    for (int base = 0; base < count; base += BATCH_CHUNK) {
+        int n = count - base < BATCH_CHUNK ? count - base : BATCH_CHUNK;
+        fm_sincos_batch(theta + base, st, ct, n);
+        fm_sincos_batch(phi + base, sp, cp, n);
+        for (int i = 0; i < n; i++) {
+            float ri = r[base + i];
+            out[base + i].x = ri * sp[i] * ct[i];
+            out[base + i].y = ri * sp[i] * st[i];
+            out[base + i].z = ri * cp[i];
+        }
+    }
+}
+
+void vec3_normalize_fast_batch(const vec3_t* in, vec3_t* out, int count) {
+    float inv_len[BATCH_CHUNK];
+
+    for (int base = 0; base < count; base += BATCH_CHUNK) {
+        int n = count - base < BATCH_CHUNK ? count - base : BATCH_CHUNK;
+        for (int i = 0; i < n; i++) {
+            vec3_t v = in[base + i];
+            inv_len[i] = v.x*v.x + v.y*v.y + v.z*v.z;
+        }
+        fm_rsqrt_batch(inv_len, inv_len, n);
+        for (int i = 0; i < n; i++) {
+            vec3_t v = in[base + i];
+            out[base + i].x = v.x * inv_len[i];
+            out[base + i].y = v.y * inv_len[i];
+            out[base + i].z = v.z * inv_len[i];
+        }
+    }
+}
+
+void vec3_slerp_batch(const vec3_t* a, const vec3_t* b, const float* t, vec3_t* out, int count) {
+    float dot[BATCH_CHUNK], theta[BATCH_CHUNK], inv_len[BATCH_CHUNK];
+    float s[BATCH_CHUNK], c[BATCH_CHUNK];
+
+    for (int base = 0; base < count; base += BATCH_CHUNK) {
+        int n = count - base < BATCH_CHUNK ? count - base : BATCH_CHUNK;
+        for (int i = 0; i < n; i++) {
+            vec3_t va = a[base + i], vb = b[base + i];
+            dot[i] = va.x*vb.x + va.y*vb.y + va.z*vb.z;
+        }
+        fm_acos_batch(dot, theta, n);
+        for (int i = 0; i < n; i++) {
+            vec3_t va = a[base + i], vb = b[base + i];
+            float rx = vb.x - va.x * dot[i];
+            float ry = vb.y - va.y * dot[i];
+            float rz = vb.z - va.z * dot[i];
+            theta[i] *= t[base + i];
+            inv_len[i] = rx*rx + ry*ry + rz*rz;
+        }
+        fm_rsqrt_batch(inv_len, inv_len, n);
+        fm_sincos_batch(theta, s, c, n);
+        for (int i = 0; i < n; i++) {
+            vec3_t va = a[base + i], vb = b[base + i];
+            float k = inv_len[i] * s[i];
+            vec3_t result;
+            result.x = va.x * c[i] + (vb.x - va.x * dot[i]) * k;
+            result.y = va.y * c[i] + (vb.y - va.y * dot[i]) * k;
+            result.z = va.z * c[i] + (vb.z - va.z * dot[i]) * k;
+            out[base + i] = result;
+        }
+    }
+}
+
 // Identity matrix
 mat4_t mat4_identity() {
     mat4_t m = {0};
@@ -63,12 +136,8 @@ mat4_t mat4_scale(float sx, float sy, float sz) {
     return m;
 }
 
-// Rotation matrix from Euler angles (XYZ order)
-mat4_t mat4_rotate_xyz(float rx, float ry, float rz) {
-    float cx = cosf(rx), sx = sinf(rx);
-    float cy = cosf(ry), sy = sinf(ry);
-    float cz = cosf(rz), sz = sinf(rz);
-
+// Rotation matrix from the sines and cosines of Euler angles (XYZ order)
+static mat4_t rotate_xyz_sincos(float cx, float sx, float cy, float sy, float cz, float sz) {
     mat4_t m;
     m.m[0] = cy * cz;
     m.m[1] = sx * sy * cz - cx * sz;
@@ -91,6 +160,26 @@ mat4_t mat4_rotate_xyz(float rx, float ry, float rz) {
     return m;
 }
 
+// Rotation matrix from Euler angles (XYZ order)
+mat4_t mat4_rotate_xyz(float rx, float ry, float rz) {
+    return rotate_xyz_sincos(cosf(rx), sinf(rx), cosf(ry), sinf(ry), cosf(rz), sinf(rz));
+}
+
+void mat4_rotate_xyz_batch(const float* rx, const float* ry, const float* rz, mat4_t* out, int count) {
+    float sx[BATCH_CHUNK], cx[BATCH_CHUNK];
+    float sy[BATCH_CHUNK], cy[BATCH_CHUNK];
+    float sz[BATCH_CHUNK], cz[BATCH_CHUNK];
+
+    for (int base = 0; base < count; base += BATCH_CHUNK) {
+        int n = count - base < BATCH_CHUNK ? count - base : BATCH_CHUNK;
+        fm_sincos_batch(rx + base, sx, cx, n);
+        fm_sincos_batch(ry + base, sy, cy, n);
+        fm_sincos_batch(rz + base, sz, cz, n);
+        for (int i = 0; i < n; i++)
+            out[base + i] = rotate_xyz_sincos(cx[i], sx[i], cy[i], sy[i], cz[i], sz[i]);
+    }
+}
+
 // Perspective projection matrix
 mat4_t mat4_frustum_asymmetric(float l, float r, float b, float t, float n, float f) {
     mat4_t m = {0};
@@ -0,0 +1,228 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include "mesh.h"
+
+typedef struct {
+    uint32_t code;
+    int index;
+} vertex_key_t;
+
+typedef struct {
+    uint64_t key;
+    int a, b;
+} edge_key_t;
+
+// Grow a buffer so it can hold at least `needed` elements
+static int grow(void** data, int* capacity, int needed, size_t elem_size) {
+    if (needed <= *capacity) return 1;
+    int cap = *capacity ? *capacity : 256;
+    while (cap < needed) cap *= 2;
+    void* p = realloc(*data, (size_t)cap * elem_size);
+    if (!p) return 0;
+    *data = p;
+    *capacity = cap;
+    return 1;
+}
+
+// Load .obj with 'v' and 'f' lines, convert faces to edges
+mesh_t* mesh_load_obj(const char* filename) {
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        perror("fopen");
+        return NULL;
+    }
+
+    mesh_t* m = calloc(1, sizeof(mesh_t));
+    if (!m) {
+        fclose(file);
+        return NULL;
+    }
+
+    char line[512];
+    int v_cap = 0, e_cap = 0;
+    int ok = 1;
+
+    while (ok && fgets(line, sizeof(line), file)) {
+        if (line[0] == 'v' && line[1] == ' ') {
+            vec3_t v;
+            if (sscanf(line + 2, "%f %f %f", &v.x, &v.y, &v.z) == 3) {
+                ok = grow((void**)&m->vertices, &v_cap, m->vertex_count + 1, sizeof(vec3_t));
+                if (ok) m->vertices[m->vertex_count++] = v;
+            }
+        } else if (line[0] == 'f' && line[1] == ' ') {
+            int indices[10];
+            int count = 0;
+
+            char* token = strtok(line + 2, " \n");
+            while (token && count < 10) {
+                int i;
+                if (sscanf(token, "%d", &i) == 1) {
+                    indices[count++] = i - 1;  // OBJ is 1-based
+                }
+                token = strtok(NULL, " \n");
+            }
+
+            ok = grow((void**)&m->edges, &e_cap, m->edge_count + count, sizeof(int[2]));
+            for (int i = 0; ok && i < count; i++) {
+                m->edges[m->edge_count][0] = indices[i];
+                m->edges[m->edge_count][1] = indices[(i + 1) % count];
+                m->edge_count++;
+            }
+        }
+    }
+
+    fclose(file);
+
+    // Drop edges that reference vertices the file never defined
+    int kept = 0;
+    for (int i = 0; ok && i < m->edge_count; i++) {
+        int a = m->edges[i][0], b = m->edges[i][1];
+        if (a >= 0 && a < m->vertex_count && b >= 0 && b < m->vertex_count) {
+            m->edges[kept][0] = a;
+            m->edges[kept][1] = b;
+            kept++;
+        }
+    }
+    m->edge_count = kept;
+
+    if (!ok) {
+        mesh_destroy(m);
+        return NULL;
+    }
+    return m;
+}
+
+// Spread the low 10 bits of v so there are two zero bits between each
+static uint32_t spread_bits(uint32_t v) {
+    v &= 0x3ff;
+    v = (v | (v << 16)) & 0x030000ff;
+    v = (v | (v << 8)) & 0x0300f00f;
+    v = (v | (v << 4)) & 0x030c30c3;
+    v = (v | (v << 2)) & 0x09249249;
+    return v;
+}
+
+static int vertex_finite(vec3_t v) {
+    return isfinite(v.x) && isfinite(v.y) && isfinite(v.z);
+}
+
+static uint32_t quantize(float v, float lo, float scale) {
+    float q = (v - lo) * scale;
+    if (!(q >= 0.0f)) q = 0.0f; // also catches NaN
+    if (q > 1023.0f) q = 1023.0f;
+    return (uint32_t)q;
+}
+
+static int compare_vertex_key(const void* a, const void* b) {
+    const vertex_key_t* x = a;
+    const vertex_key_t* y = b;
+    if (x->code != y->code) return x->code < y->code ? -1 : 1;
+    return x->index - y->index;
+}
+
+static int compare_edge_key(const void* a, const void* b) {
+    const edge_key_t* x = a;
+    const edge_key_t* y = b;
+    return (x->key > y->key) - (x->key < y->key);
+}
+
+int mesh_optimize_order(mesh_t* m) {
+    int n = m->vertex_count;
+    if (n == 0) return 1;
+
+    vertex_key_t* keys = malloc(sizeof(vertex_key_t) * n);
+    edge_key_t* edge_keys = malloc(sizeof(edge_key_t) * (m->edge_count ? m->edge_count : 1));
+    int* remap = malloc(sizeof(int) * n);
+    vec3_t* vertices = malloc(sizeof(vec3_t) * n);
+    if (!keys || !edge_keys || !remap || !vertices) {
+        free(keys);
+        free(edge_keys);
+        free(remap);
+        free(vertices);
+        return 0;
+    }
+
+    // Quantize positions to a 1024^3 grid over the bounding box of the
+    // finite vertices; NaN or infinite vertices get code 0
+    vec3_t lo = {{{ 0.0f, 0.0f, 0.0f }}}, hi = lo;
+    int found = 0;
+    for (int i = 0; i < n; i++) {
+        vec3_t v = m->vertices[i];
+        if (!vertex_finite(v)) continue;
+        if (!found) {
+            lo = hi = v;
+            found = 1;
+        }
+        if (v.x < lo.x) lo.x = v.x;
+        if (v.y < lo.y) lo.y = v.y;
+        if (v.z < lo.z) lo.z = v.z;
+        if (v.x > hi.x) hi.x = v.x;
+        if (v.y > hi.y) hi.y = v.y;
+        if (v.z > hi.z) hi.z = v.z;
+    }
+    float extent = hi.x - lo.x;
+    if (hi.y - lo.y > extent) extent = hi.y - lo.y;
+    if (hi.z - lo.z > extent) extent = hi.z - lo.z;
+    float scale = extent > 0.0f && isfinite(extent) ? 1023.0f / extent : 0.0f;
+
+    for (int i = 0; i < n; i++) {
+        vec3_t v = m->vertices[i];
+        keys[i].index = i;
+        if (!vertex_finite(v)) {
+            keys[i].code = 0;
+            continue;
+        }
+        keys[i].code = spread_bits(quantize(v.x, lo.x, scale)) |
+                       spread_bits(quantize(v.y, lo.y, scale)) << 1 |
+                       spread_bits(quantize(v.z, lo.z, scale)) << 2;
+    }
+    qsort(keys, n, sizeof(vertex_key_t), compare_vertex_key);
+
+    for (int i = 0; i < n; i++) {
+        remap[keys[i].index] = i;
+        vertices[i] = m->vertices[keys[i].index];
+    }
+
+    // Group edges by their lower endpoint so runs of edges share vertices
+    for (int i = 0; i < m->edge_count; i++) {
+        int a = remap[m->edges[i][0]];
+        int b = remap[m->edges[i][1]];
+        uint64_t lo_i = (uint64_t)(a < b ? a : b);
+        uint64_t hi_i = (uint64_t)(a < b ? b : a);
+        edge_keys[i].key = lo_i << 32 | hi_i;
+        edge_keys[i].a = a;
+        edge_keys[i].b = b;
+    }
+    qsort(edge_keys, m->edge_count, sizeof(edge_key_t), compare_edge_key);
+    for (int i = 0; i < m->edge_count; i++) {
+        m->edges[i][0] = edge_keys[i].a;
+        m->edges[i][1] = edge_keys[i].b;
+    }
+
+    // Compose with an earlier remap so it always maps original OBJ indices
+    if (m->vertex_remap) {
+        for (int i = 0; i < n; i++)
+            m->vertex_remap[i] = remap[m->vertex_remap[i]];
+        free(remap);
+    } else {
+        m->vertex_remap = remap;
+    }
+
+    free(m->vertices);
+    m->vertices = vertices;
+    free(keys);
+    free(edge_keys);
+    return 1;
+}
+
+void mesh_destroy(mesh_t* m) {
+    if (m) {
+        free(m->vertices);
+        free(m->edges);
+        free(m->vertex_remap);
+        free(m);
+    }
+}
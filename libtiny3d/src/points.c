@@ -0,0 +1,205 @@
+#include <stdlib.h>
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "points.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Points are transformed and culled this many at a time before splatting
+#define POINT_BLOCK 256
+// Below this many points per thread, extra threads cost more than they save
+#define MIN_POINTS_PER_THREAD 16384
+// Upper bound on the private accumulation buffers allocated per call
+#define SPLAT_BUFFER_BUDGET ((size_t)256 << 20)
+
+typedef struct {
+    const vec3_t* points;
+    int count;
+    const mat4_t* mvp;
+    float intensity;
+    int width, height;
+    float* accum;          // width * height buffer this thread splats into
+} splat_job_t;
+
+typedef struct {
+    float* pixels;
+    float** buffers;       // per-thread buffers to fold into pixels
+    int buffer_count;
+    size_t begin, end;
+} merge_job_t;
+
+// Add intensity to the 4 pixels around (x, y), weighted like set_pixel_f
+static void splat(float* accum, int width, int height, float x, float y, float intensity) {
+    int x0 = (int)floorf(x);
+    int y0 = (int)floorf(y);
+    float dx = x - x0;
+    float dy = y - y0;
+    float w00 = (1.0f - dx) * (1.0f - dy) * intensity;
+    float w10 = dx * (1.0f - dy) * intensity;
+    float w01 = (1.0f - dx) * dy * intensity;
+    float w11 = dx * dy * intensity;
+
+    if (x0 >= 0 && x0 + 1 < width && y0 >= 0 && y0 + 1 < height) {
+        float* p = accum + (size_t)y0 * width + x0;
+        p[0] += w00;
+        p[1] += w10;
+        p[width] += w01;
+        p[width + 1] += w11;
+        return;
+    }
+
+    // Edge of the canvas: only some of the 4 pixels exist
+    if (y0 >= 0 && y0 < height) {
+        if (x0 >= 0 && x0 < width) accum[(size_t)y0 * width + x0] += w00;
+        if (x0 + 1 >= 0 && x0 + 1 < width) accum[(size_t)y0 * width + x0 + 1] += w10;
+    }
+    if (y0 + 1 >= 0 && y0 + 1 < height) {
+        if (x0 >= 0 && x0 < width) accum[(size_t)(y0 + 1) * width + x0] += w01;
+        if (x0 + 1 >= 0 && x0 + 1 < width) accum[(size_t)(y0 + 1) * width + x0 + 1] += w11;
+    }
+}
+
+static void* splat_main(void* arg) {
+    splat_job_t* job = arg;
+    const float* m = job->mvp->m;
+    float half_w = 0.5f * job->width;
+    float half_h = 0.5f * job->height;
+    float sx[POINT_BLOCK], sy[POINT_BLOCK];
+
+    for (int base = 0; base < job->count; base += POINT_BLOCK) {
+        int n = job->count - base < POINT_BLOCK ? job->count - base : POINT_BLOCK;
+        const vec3_t* p = job->points + base;
+
+        // Transform the block and keep the points that land on the canvas
+        int kept = 0;
+        for (int i = 0; i < n; i++) {
+            float x = m[0]*p[i].x + m[4]*p[i].y + m[8]*p[i].z + m[12];
+            float y = m[1]*p[i].x + m[5]*p[i].y + m[9]*p[i].z + m[13];
+            float w = m[3]*p[i].x + m[7]*p[i].y + m[11]*p[i].z + m[15];
+            if (w <= 0.0f) continue; // behind the camera
+            float inv_w = 1.0f / w;
+            float px = (x * inv_w + 1.0f) * half_w;
+            float py = (1.0f - y * inv_w) * half_h;
+            if (px > -1.0f && px < job->width && py > -1.0f && py < job->height) {
+                sx[kept] = px;
+                sy[kept] = py;
+                kept++;
+            }
+        }
+
+        for (int i = 0; i < kept; i++)
+            splat(job->accum, job->width, job->height, sx[i], sy[i], job->intensity);
+    }
+    return NULL;
+}
+
+// pixels[i] = min(pixels[i] + sum of buffers[k][i], 1) over [begin, end)
+static void* merge_main(void* arg) {
+    merge_job_t* job = arg;
+    size_t i = job->begin;
+#if defined(__SSE2__)
+    __m128 one = _mm_set1_ps(1.0f);
+    for (; i + 4 <= job->end; i += 4) {
+        __m128 sum = _mm_loadu_ps(job->pixels + i);
+        for (int k = 0; k < job->buffer_count; k++)
+            sum = _mm_add_ps(sum, _mm_loadu_ps(job->buffers[k] + i));
+        _mm_storeu_ps(job->pixels + i, _mm_min_ps(sum, one));
+    }
+#endif
+    for (; i < job->end; i++) {
+        float sum = job->pixels[i];
+        for (int k = 0; k < job->buffer_count; k++)
+            sum += job->buffers[k][i];
+        job->pixels[i] = sum > 1.0f ? 1.0f : sum;
+    }
+    return NULL;
+}
+
+// Run fn over jobs[0..count): jobs 1.. on new threads, job 0 on the caller
+static void run_parallel(void* (*fn)(void*), void* jobs, size_t job_size, int count, pthread_t* threads) {
+    char* base = jobs;
+    int started = 1;
+    for (; started < count; started++) {
+        if (pthread_create(&threads[started], NULL, fn, base + started * job_size) != 0)
+            break;
+    }
+    // If a thread couldn't be started, the caller does the remaining jobs
+    for (int t = started; t < count; t++)
+        fn(base + t * job_size);
+    fn(base);
+    for (int t = 1; t < started; t++)
+        pthread_join(threads[t], NULL);
+}
+
+void render_points(canvas_t* canvas, const vec3_t* points, int point_count, mat4_t mvp, float intensity, int thread_count) {
+    if (point_count <= 0) return;
+    if (thread_count <= 0) thread_count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int max_threads = (point_count + MIN_POINTS_PER_THREAD - 1) / MIN_POINTS_PER_THREAD;
+    if (thread_count > max_threads) thread_count = max_threads;
+    if (thread_count < 1) thread_count = 1;
+
+    // Every thread but the first needs a full canvas-sized buffer
+    size_t pixel_count = (size_t)canvas->width * canvas->height;
+    size_t buffer_bytes = pixel_count * sizeof(float);
+    size_t max_buffers = buffer_bytes ? SPLAT_BUFFER_BUDGET / buffer_bytes : 0;
+    if ((size_t)thread_count - 1 > max_buffers) thread_count = (int)max_buffers + 1;
+
+    splat_job_t* splats = calloc(thread_count, sizeof(splat_job_t));
+    merge_job_t* merges = calloc(thread_count, sizeof(merge_job_t));
+    pthread_t* threads = calloc(thread_count, sizeof(pthread_t));
+    float** buffers = calloc(thread_count, sizeof(float*));
+    if (!splats || !merges || !threads || !buffers) {
+        free(splats);
+        free(merges);
+        free(threads);
+        free(buffers);
+        return;
+    }
+
+    // Thread 0 splats straight into the canvas; the others get private
+    // buffers. Use fewer threads if a buffer can't be allocated.
+    int buffer_count = 0;
+    for (int t = 1; t < thread_count; t++) {
+        buffers[buffer_count] = calloc(pixel_count, sizeof(float));
+        if (!buffers[buffer_count]) break;
+        buffer_count++;
+    }
+    thread_count = buffer_count + 1;
+
+    int per_thread = (point_count + thread_count - 1) / thread_count;
+    for (int t = 0; t < thread_count; t++) {
+        int begin = t * per_thread < point_count ? t * per_thread : point_count;
+        int end = begin + per_thread < point_count ? begin + per_thread : point_count;
+        splats[t].points = points + begin;
+        splats[t].count = end - begin;
+        splats[t].mvp = &mvp;
+        splats[t].intensity = intensity;
+        splats[t].width = canvas->width;
+        splats[t].height = canvas->height;
+        splats[t].accum = t == 0 ? canvas->pixels : buffers[t - 1];
+    }
+    run_parallel(splat_main, splats, sizeof(splat_job_t), thread_count, threads);
+
+    // Fold the private buffers into the canvas, one slice per thread
+    size_t slice = (pixel_count / thread_count + 3) & ~(size_t)3;
+    for (int t = 0; t < thread_count; t++) {
+        size_t begin = t * slice < pixel_count ? t * slice : pixel_count;
+        size_t end = begin + slice < pixel_count ? begin + slice : pixel_count;
+        merges[t].pixels = canvas->pixels;
+        merges[t].buffers = buffers;
+        merges[t].buffer_count = buffer_count;
+        merges[t].begin = begin;
+        merges[t].end = t == thread_count - 1 ? pixel_count : end;
+    }
+    run_parallel(merge_main, merges, sizeof(merge_job_t), thread_count, threads);
+
+    for (int k = 0; k < buffer_count; k++)
+        free(buffers[k]);
+    free(buffers);
+    free(threads);
+    free(merges);
+    free(splats);
+}
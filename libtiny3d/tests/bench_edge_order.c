@@ -0,0 +1,186 @@
+// bench_edge_order.c – render_wireframe before and after mesh_optimize_order
+//
+// Builds a large sphere mesh with its vertices and faces shuffled (the
+// worst case for an OBJ export), then times rendering it as loaded and
+// after reordering, and fails if the two images differ. On Linux the cache
+// misses of each render are counted with perf_event_open when the kernel
+// allows it; the mean index jump between consecutive edges is always shown
+// as a locality proxy.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "canvas.h"
+#include "math3d.h"
+#include "lighting.h"
+#include "renderer.h"
+#include "mesh.h"
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define RINGS 720
+#define SEGMENTS 720
+#define CANVAS_SIZE 2048
+
+static double now_ms() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+static int open_cache_miss_counter() {
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+    return -1;
+#endif
+}
+
+// Sphere of RINGS x SEGMENTS vertices with 4 edges per quad, in shuffled order
+static mesh_t* build_shuffled_sphere() {
+    int n = RINGS * SEGMENTS;
+    int quads = (RINGS - 1) * SEGMENTS;
+    mesh_t* m = calloc(1, sizeof(mesh_t));
+    m->vertices = malloc(sizeof(vec3_t) * n);
+    m->edges = malloc(sizeof(int[2]) * quads * 4);
+    m->vertex_count = n;
+    m->edge_count = quads * 4;
+
+    int* perm = malloc(sizeof(int) * n);
+    for (int i = 0; i < n; i++) perm[i] = i;
+    for (int i = n - 1; i > 0; i--) {
+        int j = rand() % (i + 1);
+        int t = perm[i];
+        perm[i] = perm[j];
+        perm[j] = t;
+    }
+
+    for (int r = 0; r < RINGS; r++) {
+        for (int s = 0; s < SEGMENTS; s++) {
+            float phi = M_PI * (r + 0.5f) / RINGS;
+            float theta = 2.0f * M_PI * s / SEGMENTS;
+            m->vertices[perm[r * SEGMENTS + s]] = vec3_from_spherical(1.0f, theta, phi);
+        }
+    }
+
+    int* face_order = malloc(sizeof(int) * quads);
+    for (int i = 0; i < quads; i++) face_order[i] = i;
+    for (int i = quads - 1; i > 0; i--) {
+        int j = rand() % (i + 1);
+        int t = face_order[i];
+        face_order[i] = face_order[j];
+        face_order[j] = t;
+    }
+    for (int f = 0; f < quads; f++) {
+        int r = face_order[f] / SEGMENTS;
+        int s = face_order[f] % SEGMENTS;
+        int quad[4] = {
+            perm[r * SEGMENTS + s],
+            perm[r * SEGMENTS + (s + 1) % SEGMENTS],
+            perm[(r + 1) * SEGMENTS + (s + 1) % SEGMENTS],
+            perm[(r + 1) * SEGMENTS + s]
+        };
+        for (int k = 0; k < 4; k++) {
+            m->edges[f * 4 + k][0] = quad[k];
+            m->edges[f * 4 + k][1] = quad[(k + 1) % 4];
+        }
+    }
+
+    free(perm);
+    free(face_order);
+    return m;
+}
+
+// Locality proxy that needs no perf counters: mean distance in the vertex
+// array between the first endpoints of consecutive edges
+static double mean_index_jump(const mesh_t* m) {
+    double total = 0.0;
+    for (int i = 1; i < m->edge_count; i++)
+        total += abs(m->edges[i][0] - m->edges[i - 1][0]);
+    return m->edge_count > 1 ? total / (m->edge_count - 1) : 0.0;
+}
+
+static canvas_t* bench(const char* label, mesh_t* m, mat4_t mvp, light_t* lights, int counter) {
+    canvas_t* canvas = canvas_create(CANVAS_SIZE, CANVAS_SIZE);
+    long long misses = -1;
+
+#ifdef __linux__
+    if (counter >= 0) {
+        ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+        ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+    double t0 = now_ms();
+    render_wireframe(canvas, m->vertices, m->vertex_count, m->edges, m->edge_count, mvp, lights, 2);
+    double t1 = now_ms();
+#ifdef __linux__
+    if (counter >= 0) {
+        ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(counter, &misses, sizeof(misses)) != sizeof(misses)) misses = -1;
+    }
+#endif
+
+    if (misses >= 0)
+        printf("%-10s %8.1f ms  %12lld cache misses  mean edge index jump %.1f\n",
+               label, t1 - t0, misses, mean_index_jump(m));
+    else
+        printf("%-10s %8.1f ms  cache misses n/a  mean edge index jump %.1f\n",
+               label, t1 - t0, mean_index_jump(m));
+    return canvas;
+}
+
+int main() {
+    srand(52);
+    mesh_t* m = build_shuffled_sphere();
+    printf("%d vertices, %d edges, %dx%d canvas\n", m->vertex_count, m->edge_count, CANVAS_SIZE, CANVAS_SIZE);
+
+    light_t lights[2] = {
+        {{ 0.0f, 0.0f, -1.0f }, 0.8f},
+        {{ 1.0f, 1.0f, -1.0f }, 0.5f}
+    };
+    mat4_t model = mat4_mul(mat4_translate(0, 0, -2.5f), mat4_rotate_xyz(0.4f, 0.3f, 0));
+    mat4_t mvp = mat4_mul(mat4_frustum_asymmetric(-1, 1, -1, 1, 1.0f, 10.0f), model);
+
+    int counter = open_cache_miss_counter();
+    canvas_t* before = bench("as loaded", m, mvp, lights, counter);
+
+    double t0 = now_ms();
+    if (!mesh_optimize_order(m)) {
+        fprintf(stderr, "mesh_optimize_order failed\n");
+        return 1;
+    }
+    printf("mesh_optimize_order: %.1f ms\n", now_ms() - t0);
+    canvas_t* after = bench("optimized", m, mvp, lights, counter);
+
+    // Reordering only changes the order of non-negative clamped adds
+    double max_diff = 0.0;
+    for (int i = 0; i < CANVAS_SIZE * CANVAS_SIZE; i++)
+        max_diff = fmax(max_diff, fabs(after->pixels[i] - before->pixels[i]));
+    printf("max pixel difference: %g\n", max_diff);
+
+#ifdef __linux__
+    if (counter >= 0) close(counter);
+#endif
+    canvas_destroy(before);
+    canvas_destroy(after);
+    mesh_destroy(m);
+    return max_diff < 1e-3 ? 0 : 1;
+}
@@ -0,0 +1,74 @@
+// bench_points.c – point-cloud splat throughput against set_pixel_f
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "canvas.h"
+#include "math3d.h"
+#include "points.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define WIDTH 1024
+#define HEIGHT 1024
+#define POINTS 4000000
+
+static double now_ms() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+int main(int argc, char** argv) {
+    int threads = argc > 1 ? atoi(argv[1]) : 0;
+
+    // Noisy spherical shell, like a scan of a round object
+    float* r = malloc(sizeof(float) * POINTS);
+    float* theta = malloc(sizeof(float) * POINTS);
+    float* phi = malloc(sizeof(float) * POINTS);
+    vec3_t* points = malloc(sizeof(vec3_t) * POINTS);
+    srand(52);
+    for (int i = 0; i < POINTS; i++) {
+        r[i] = 1.0f + 0.02f * ((float)rand() / RAND_MAX - 0.5f);
+        theta[i] = 2.0f * M_PI * rand() / RAND_MAX;
+        phi[i] = acosf(2.0f * rand() / RAND_MAX - 1.0f);
+    }
+    vec3_from_spherical_batch(r, theta, phi, points, POINTS);
+
+    mat4_t model = mat4_mul(mat4_translate(0, 0, -3.0f), mat4_rotate_xyz(0.4f, 0.3f, 0));
+    mat4_t mvp = mat4_mul(mat4_frustum_asymmetric(-1, 1, -1, 1, 1.0f, 10.0f), model);
+    float intensity = 0.05f;
+
+    // Reference: project and set_pixel_f one point at a time
+    canvas_t* ref = canvas_create(WIDTH, HEIGHT);
+    double t0 = now_ms();
+    for (int i = 0; i < POINTS; i++) {
+        vec3_t p = mat4_mul_vec3(mvp, points[i]);
+        set_pixel_f(ref, (p.x + 1.0f) * 0.5f * WIDTH, (1.0f - p.y) * 0.5f * HEIGHT, intensity);
+    }
+    double t1 = now_ms();
+
+    canvas_t* canvas = canvas_create(WIDTH, HEIGHT);
+    render_points(canvas, points, POINTS, mvp, intensity, threads);
+    double t2 = now_ms();
+
+    double max_diff = 0.0;
+    for (int i = 0; i < WIDTH * HEIGHT; i++)
+        max_diff = fmax(max_diff, fabs(canvas->pixels[i] - ref->pixels[i]));
+
+    printf("%d points on %dx%d\n", POINTS, WIDTH, HEIGHT);
+    printf("set_pixel_f:   %8.1f ms  %6.1f Mpoints/s\n", t1 - t0, POINTS / (t1 - t0) / 1000.0);
+    printf("render_points: %8.1f ms  %6.1f Mpoints/s\n", t2 - t1, POINTS / (t2 - t1) / 1000.0);
+    printf("max pixel difference: %g\n", max_diff);
+
+    canvas_save_pgm(canvas, "points.pgm");
+    canvas_destroy(canvas);
+    canvas_destroy(ref);
+    free(r);
+    free(theta);
+    free(phi);
+    free(points);
+    return max_diff < 1e-3 ? 0 : 1;
+}
@@ -0,0 +1,260 @@
+// test_fastmath.c – accuracy and speed of the fast-math batch kernels
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+#include <time.h>
+#include "fastmath.h"
+#include "math3d.h"
+
+#define N 100000
+#define RSQRT_CALLS 20000000
+
+static double now_ms() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+static float x[N], a[N], b[N], c[N];
+static mat4_t rot_fast[N], rot_ref[N];
+
+static int check(const char* name, double err, double bound) {
+    printf("%-27s max error %.3g (bound %.3g) %s\n", name, err, bound, err <= bound ? "ok" : "FAIL");
+    return err <= bound;
+}
+
+int main() {
+    int ok = 1;
+    double err;
+    double t_rsqrt[5];
+
+    // sincos over |x| <= 8192
+    for (int i = 0; i < N; i++) x[i] = -8192.0f + 16384.0f * i / (N - 1);
+    fm_sincos_batch(x, a, b, N);
+    err = 0.0;
+    for (int i = 0; i < N; i++) {
+        err = fmax(err, fabs(a[i] - sin((double)x[i])));
+        err = fmax(err, fabs(b[i] - cos((double)x[i])));
+    }
+    ok &= check("fm_sincos_batch", err, 3e-7);
+
+    for (int i = 0; i < N; i++) x[i] = -10.0f + 20.0f * i / (N - 1);
+    err = 0.0;
+    for (int i = 0; i < N; i++) {
+        float s, co;
+        fm_sincos(x[i], &s, &co);
+        err = fmax(err, fabs(s - sin((double)x[i])));
+        err = fmax(err, fabs(co - cos((double)x[i])));
+    }
+    ok &= check("fm_sincos", err, 3e-7);
+
+    // Outside FM_SINCOS_MAX both paths must hand over to sinf/cosf exactly
+    float wide[5] = {1e6f, -3e9f, INFINITY, NAN, 1.0f};
+    float ws[5], wc[5];
+    fm_sincos_batch(wide, ws, wc, 5);
+    err = 0.0;
+    for (int i = 0; i < 4; i++) {
+        float s, co;
+        fm_sincos(wide[i], &s, &co);
+        float rs = sinf(wide[i]), rc = cosf(wide[i]);
+        int same = (rs != rs) ? (s != s && co != co && ws[i] != ws[i] && wc[i] != wc[i])
+                              : (s == rs && co == rc && ws[i] == rs && wc[i] == rc);
+        if (!same) err = INFINITY;
+    }
+    ok &= check("fm_sincos outside domain", err, 0.0);
+
+    // acos over [-1, 1]
+    for (int i = 0; i < N; i++) x[i] = -1.0f + 2.0f * i / (N - 1);
+    fm_acos_batch(x, a, N);
+    err = 0.0;
+    for (int i = 0; i < N; i++) {
+        err = fmax(err, fabs(a[i] - acos((double)x[i])));
+        err = fmax(err, fabs(fm_acos(x[i]) - acos((double)x[i])));
+    }
+    ok &= check("fm_acos(_batch)", err, 1e-6);
+
+    // Clamping and NaN must agree between SIMD lanes and the scalar tail
+    float acos_edge[5] = {NAN, 2.0f, -1.5f, INFINITY, NAN};
+    float acos_ref[5] = {NAN, 0.0f, acosf(-1.0f), 0.0f, NAN};
+    float acos_out[5];
+    fm_acos_batch(acos_edge, acos_out, 5);
+    err = 0.0;
+    for (int i = 0; i < 5; i++) {
+        float got[2] = {acos_out[i], fm_acos(acos_edge[i])};
+        for (int k = 0; k < 2; k++) {
+            if (acos_ref[i] != acos_ref[i]) err = got[k] != got[k] ? err : INFINITY;
+            else err = fmax(err, fabs(got[k] - acos_ref[i]));
+        }
+    }
+    if (err != err) err = INFINITY;
+    ok &= check("fm_acos edge inputs", err, 1e-6);
+
+    // rsqrt relative error over many magnitudes
+    for (int i = 0; i < N; i++) x[i] = powf(10.0f, -6.0f + 12.0f * i / (N - 1));
+    fm_rsqrt_batch(x, a, N);
+    err = 0.0;
+    for (int i = 0; i < N; i++) {
+        double ref = 1.0 / sqrt((double)x[i]);
+        err = fmax(err, fabs(a[i] - ref) / ref);
+        err = fmax(err, fabs(fm_rsqrt(x[i]) - ref) / ref);
+    }
+    ok &= check("fm_rsqrt(_batch)", err, 1e-6);
+
+    // Outside the normal range the scalar path, SIMD lanes and scalar tail
+    // must all give the exact 1 / sqrtf (0 for x <= 0, NaN for NaN)
+    float edge[9] = {1e-39f, 1e-45f, FLT_MIN, FLT_MAX, INFINITY, 0.0f, -1.0f, NAN, 1e-39f};
+    float edge_out[9];
+    fm_rsqrt_batch(edge, edge_out, 9);
+    err = 0.0;
+    for (int i = 0; i < 9; i++) {
+        float ref = edge[i] > 0.0f || edge[i] != edge[i] ? 1.0f / sqrtf(edge[i]) : 0.0f;
+        float got[2] = {edge_out[i], fm_rsqrt(edge[i])};
+        for (int k = 0; k < 2; k++) {
+            if (ref != ref) err = got[k] != got[k] ? err : INFINITY;
+            else if (ref == 0.0f) err = got[k] == 0.0f ? err : INFINITY;
+            else err = fmax(err, fabs(got[k] - ref) / ref);
+        }
+    }
+    if (err != err) err = INFINITY;
+    ok &= check("fm_rsqrt edge inputs", err, 1e-6);
+
+    // Scalar rsqrt as used by vec3_normalize_fast: dependent chain (latency)
+    // and independent calls (throughput) against 1.0f / sqrtf
+    volatile float seed = 1.0f;
+    float chain_ref = seed, chain_fast = seed;
+    t_rsqrt[0] = now_ms();
+    for (int i = 0; i < RSQRT_CALLS; i++) chain_ref = 1.0f / sqrtf(chain_ref + 1.0f);
+    t_rsqrt[1] = now_ms();
+    for (int i = 0; i < RSQRT_CALLS; i++) chain_fast = fm_rsqrt(chain_fast + 1.0f);
+    t_rsqrt[2] = now_ms();
+    for (int r = 0; r < RSQRT_CALLS / N; r++)
+        for (int i = 0; i < N; i++) a[i] = 1.0f / sqrtf(x[i]);
+    t_rsqrt[3] = now_ms();
+    for (int r = 0; r < RSQRT_CALLS / N; r++)
+        for (int i = 0; i < N; i++) b[i] = fm_rsqrt(x[i]);
+    t_rsqrt[4] = now_ms();
+    printf("  %d scalar rsqrt: latency 1/sqrtf %.1f ms, fm_rsqrt %.1f ms; "
+           "throughput 1/sqrtf %.1f ms, fm_rsqrt %.1f ms (%g)\n",
+           RSQRT_CALLS, t_rsqrt[1] - t_rsqrt[0], t_rsqrt[2] - t_rsqrt[1],
+           t_rsqrt[3] - t_rsqrt[2], t_rsqrt[4] - t_rsqrt[3],
+           chain_ref + chain_fast + (a[N / 2] - b[N / 2]) * 0.0f);
+
+    // Batch rotation matrices against the libm version
+    for (int i = 0; i < N; i++) {
+        a[i] = 0.001f * i;
+        b[i] = -0.0007f * i;
+        c[i] = 0.0003f * i;
+    }
+    double t0 = now_ms();
+    for (int i = 0; i < N; i++) rot_ref[i] = mat4_rotate_xyz(a[i], b[i], c[i]);
+    double t1 = now_ms();
+    mat4_rotate_xyz_batch(a, b, c, rot_fast, N);
+    double t2 = now_ms();
+    err = 0.0;
+    for (int i = 0; i < N; i++) {
+        for (int k = 0; k < 16; k++) err = fmax(err, fabs(rot_fast[i].m[k] - rot_ref[i].m[k]));
+    }
+    ok &= check("mat4_rotate_xyz_batch", err, 2e-6);
+    printf("  %d matrices: libm %.2f ms, batch %.2f ms\n", N, t1 - t0, t2 - t1);
+
+    // Spherical samples and slerp against the scalar versions
+    vec3_t* sph = malloc(sizeof(vec3_t) * N);
+    vec3_t* va = malloc(sizeof(vec3_t) * N);
+    vec3_t* vb = malloc(sizeof(vec3_t) * N);
+    vec3_t* out = malloc(sizeof(vec3_t) * N);
+    for (int i = 0; i < N; i++) {
+        a[i] = 0.5f + 0.00001f * i;
+        b[i] = 0.0013f * i;
+        c[i] = 0.0007f * i;
+    }
+    t0 = now_ms();
+    for (int i = 0; i < N; i++) sph[i] = vec3_from_spherical(a[i], b[i], c[i]);
+    t1 = now_ms();
+    vec3_from_spherical_batch(a, b, c, out, N);
+    t2 = now_ms();
+    err = 0.0;
+    for (int i = 0; i < N; i++) {
+        err = fmax(err, fabs(out[i].x - sph[i].x));
+        err = fmax(err, fabs(out[i].y - sph[i].y));
+        err = fmax(err, fabs(out[i].z - sph[i].z));
+    }
+    ok &= check("vec3_from_spherical_batch", err, 2e-6);
+    printf("  %d samples: libm %.2f ms, batch %.2f ms\n", N, t1 - t0, t2 - t1);
+
+    for (int i = 0; i < N; i++) {
+        va[i] = vec3_from_spherical(1.0f, 0.0011f * i, 0.3f + 0.00002f * i);
+        vb[i] = vec3_from_spherical(1.0f, 0.0017f * i + 1.0f, 1.2f + 0.00001f * i);
+        a[i] = (float)(i % 101) / 100.0f;
+    }
+    t0 = now_ms();
+    for (int i = 0; i < N; i++) sph[i] = vec3_slerp(va[i], vb[i], a[i]);
+    t1 = now_ms();
+    vec3_slerp_batch(va, vb, a, out, N);
+    t2 = now_ms();
+    err = 0.0;
+    for (int i = 0; i < N; i++) {
+        err = fmax(err, fabs(out[i].x - sph[i].x));
+        err = fmax(err, fabs(out[i].y - sph[i].y));
+        err = fmax(err, fabs(out[i].z - sph[i].z));
+    }
+    ok &= check("vec3_slerp_batch", err, 1e-5);
+    printf("  %d slerps: libm %.2f ms, batch %.2f ms\n", N, t1 - t0, t2 - t1);
+
+    // Degenerate inputs must agree between SIMD lanes and the scalar tail:
+    // zero-length vectors normalize to zero, slerp(a, a, t) returns a
+    vec3_t zero[5] = {{0}}, zero_out[5];
+    vec3_normalize_fast_batch(zero, zero_out, 5);
+    err = 0.0;
+    for (int i = 0; i < 5; i++) {
+        vec3_t s = vec3_normalize_fast(zero[i]);
+        err = fmax(err, fabs(zero_out[i].x) + fabs(zero_out[i].y) + fabs(zero_out[i].z));
+        err = fmax(err, fabs(s.x) + fabs(s.y) + fabs(s.z));
+    }
+    if (err != err) err = INFINITY; // NaN must fail the check
+    ok &= check("normalize zero vector", err, 0.0);
+
+    // Squared lengths that are subnormal or overflow to inf give the same
+    // vector as scaling by 1.0f / sqrtf
+    vec3_t tiny_huge[5] = {{{{1e-20f, 0, 0}}}, {{{2e19f, 0, 0}}}, {{{0, -1e-20f, 0}}},
+                           {{{0, 0, 3e-22f}}}, {{{1e-20f, 0, 0}}}};
+    vec3_t tiny_huge_out[5];
+    vec3_normalize_fast_batch(tiny_huge, tiny_huge_out, 5);
+    err = 0.0;
+    for (int i = 0; i < 5; i++) {
+        vec3_t r = tiny_huge[i];
+        float len_sq = r.x*r.x + r.y*r.y + r.z*r.z;
+        float inv_len = 1.0f / sqrtf(len_sq);
+        r.x *= inv_len;
+        r.y *= inv_len;
+        r.z *= inv_len;
+        vec3_t s = vec3_normalize_fast(tiny_huge[i]);
+        err = fmax(err, fabs(s.x - r.x) + fabs(s.y - r.y) + fabs(s.z - r.z));
+        err = fmax(err, fabs(tiny_huge_out[i].x - r.x) + fabs(tiny_huge_out[i].y - r.y) +
+                        fabs(tiny_huge_out[i].z - r.z));
+    }
+    if (err != err) err = INFINITY;
+    ok &= check("normalize tiny/huge vectors", err, 1e-6);
+
+    // Axis vectors keep dot(a, a) exactly 1
+    float same_t[5] = {0.0f, 0.25f, 0.5f, 0.75f, 1.0f};
+    vec3_t axes[5] = {{{{1, 0, 0}}}, {{{0, 1, 0}}}, {{{0, 0, 1}}}, {{{-1, 0, 0}}}, {{{0, -1, 0}}}};
+    for (int i = 0; i < 5; i++) va[i] = axes[i];
+    vec3_slerp_batch(va, va, same_t, out, 5);
+    err = 0.0;
+    for (int i = 0; i < 5; i++) {
+        vec3_t s = vec3_slerp(va[i], va[i], same_t[i]);
+        err = fmax(err, fabs(out[i].x - va[i].x) + fabs(out[i].y - va[i].y) + fabs(out[i].z - va[i].z));
+        err = fmax(err, fabs(s.x - va[i].x) + fabs(s.y - va[i].y) + fabs(s.z - va[i].z));
+    }
+    if (err != err) err = INFINITY;
+    ok &= check("slerp(a, a, t)", err, 1e-5);
+
+    free(sph);
+    free(va);
+    free(vb);
+    free(out);
+
+    printf(ok ? "All fast-math checks passed\n" : "Fast-math checks FAILED\n");
+    return ok ? 0 : 1;
+}